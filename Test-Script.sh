@@ -1,14 +1,21 @@
 #!/bin/bash
 
-echo "Generate test matrices with Python if no test data found"
+echo "Compiling all versions..."
+echo
+make
+
+echo
+echo "Generate test matrices with bin/generate if no test data found"
 echo
 
 # Create data directory if it doesn't exist
 mkdir -p data
 
 # Generate matrices for reasonable benchmark sizes
-sizes=( "5 4" "4 5" "10 10" "100 100" "200 200" "500 500" )
+sizes=( "5 4" "4 5" "10 10" "100 100" "200 200" "500 500" "1000 1000" "2000 2000" )
 
+# Every file gets its own seed, so the inputs are the same on every run
+seed=1
 for size in "${sizes[@]}"; do
     rows=$(echo $size | cut -d' ' -f1)
     cols=$(echo $size | cut -d' ' -f2)
@@ -18,25 +25,23 @@ for size in "${sizes[@]}"; do
 
     if [ ! -f "$file_a" ]; then
         echo "Generating ${rows}x${cols} matrix A..."
-        python3 random_float_matrix.py $rows $cols "$file_a"
+        bin/generate -s $seed $rows $cols "$file_a"
     fi
 
     if [ ! -f "$file_b" ]; then
         echo "Generating ${rows}x${cols} matrix B..."
-        python3 random_float_matrix.py $cols $rows "$file_b"  # Note: cols x rows for valid multiplication
+        bin/generate -s $((seed + 1)) $cols $rows "$file_b"  # Note: cols x rows for valid multiplication
     fi
-done
 
-echo "Compiling all versions..."
-echo
-make
+    seed=$((seed + 2))
+done
 
 echo
 echo "Benchmarking different implementations..."
 echo
 
 # Test matrices to benchmark (reasonable sizes)
-test_sizes=("10x10" "100x100" "200x200" "500x500")
+test_sizes=("10x10" "100x100" "200x200" "500x500" "1000x1000" "2000x2000")
 
 for size in "${test_sizes[@]}"; do
     echo "* * * * * * * ${size} Matrix Multiplication"
@@ -52,17 +57,19 @@ for size in "${test_sizes[@]}"; do
         continue
     fi
 
+    result="data/result_${size}.txt"
+
     echo "Sequential:"
-    bin/seq "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:)"
+    bin/seq -o "$result" "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:|Output:)"
 
     echo "OpenMP:"
-    bin/omp "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:|threads)"
+    bin/omp -o "$result" "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:|threads|Output:)"
 
     echo "Pthreads:"
-    bin/thread2 "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:|threads)"
+    bin/thread2 -o "$result" "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:|threads|Output:)"
 
     echo "MPI (4 processes):"
-    mpirun -np 4 bin/mpi "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:)"
+    mpirun -np 4 bin/mpi -o "$result" "$matrix_a" "$matrix_b" 2>/dev/null | grep -E "(Time:|Matrix Multiplication:|Output:)"
 
     echo
     echo "---"
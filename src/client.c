@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define DEFAULT_SOCKET_PATH "/tmp/matrix.sock"
+
+// The server opens files relative to its own directory, so MUL paths are sent
+// absolute: operands through realpath(), the output (which may not exist yet)
+// under the client's working directory
+static void absolute_path(const char *path, int is_output, char *resolved) {
+    if (!is_output) {
+        if (!realpath(path, resolved)) {
+            perror(path);
+            exit(EXIT_FAILURE);
+        }
+        return;
+    }
+
+    char cwd[PATH_MAX];
+    if (path[0] == '/') {
+        snprintf(resolved, PATH_MAX, "%s", path);
+    } else if (!getcwd(cwd, sizeof(cwd)) ||
+               snprintf(resolved, PATH_MAX, "%s/%s", cwd, path) >= PATH_MAX) {
+        printf("Error: Cannot resolve %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = DEFAULT_SOCKET_PATH;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "+s:")) != -1) {
+        if (opt == 's')
+            socket_path = optarg;
+    }
+
+    if (optind >= argc) {
+        printf("Usage: %s [-s socket_path] <command> [arguments...]\n", argv[0]);
+        printf("Commands: MUL <matrix_a> <matrix_b> [output_file]\n");
+        printf("          SHM <shm_a> <shm_b> <shm_result>\n");
+        printf("          STATS | SHUTDOWN\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("Error connecting to server");
+        exit(EXIT_FAILURE);
+    }
+
+    // Send the arguments as one request line
+    int file_job = strcmp(argv[optind], "MUL") == 0;
+    for (int i = optind; i < argc; i++) {
+        char resolved[PATH_MAX];
+        const char *arg = argv[i];
+        if (file_job && i > optind) {
+            absolute_path(arg, i - optind == 3, resolved);
+            arg = resolved;
+        }
+        dprintf(fd, "%s%s", arg, i == argc - 1 ? "\n" : " ");
+    }
+
+    // Print the reply, the exit status tells whether the server answered OK
+    char reply[1024];
+    ssize_t length = 0, n;
+    while (length < (ssize_t)sizeof(reply) - 1 &&
+           (n = read(fd, reply + length, sizeof(reply) - 1 - length)) > 0) {
+        length += n;
+    }
+    reply[length] = '\0';
+    close(fd);
+
+    fputs(reply, stdout);
+    return strncmp(reply, "OK", 2) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
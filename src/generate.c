@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <omp.h>
+#include "matrix.h"
+
+// Values are drawn as steps of 1e-6 in [0, 100), dividing keeps the binary
+// value identical to what the printed text reads back as
+#define VALUE_STEPS 100000000ULL
+#define STEPS_PER_UNIT 1000000
+
+typedef enum { DENSE, SPARSE, BANDED, ILL_CONDITIONED } distribution_t;
+
+typedef struct {
+    distribution_t kind;
+    uint64_t seed;
+    double density;
+    int bandwidth;
+    double condition_exponent;
+    int rows;
+    int cols;
+} generator_t;
+
+#define GOLDEN_GAMMA 0x9E3779B97F4A7C15ULL
+
+// SplitMix64 finalizer
+static uint64_t mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Counter-based random number for (seed, stream, row, col). Seed and stream
+// are hashed into a key first, so streams are independent of each other; the
+// (row, col) counter is then mixed with the key in two finalizer rounds.
+// Any element can be computed on its own, so every tile is reproducible no
+// matter which thread or process generates it.
+static uint64_t counter_random(uint64_t seed, uint64_t stream, int row, int col) {
+    uint64_t key = mix64(mix64(seed + GOLDEN_GAMMA) + (stream + 1) * GOLDEN_GAMMA);
+    uint64_t counter = ((uint64_t)(uint32_t)row << 32) | (uint32_t)col;
+    uint64_t x = mix64(key ^ counter);
+    return mix64(x + key);
+}
+
+// Uniform value in [0, 1) from the top 53 bits
+static double counter_uniform(uint64_t seed, uint64_t stream, int row, int col) {
+    return (counter_random(seed, stream, row, col) >> 11) * 0x1.0p-53;
+}
+
+// Value at (row, col) in steps, 0 for structural zeros
+static uint64_t element_steps(const generator_t *g, int row, int col) {
+    if (g->kind == SPARSE && counter_uniform(g->seed, 1, row, col) >= g->density)
+        return 0;
+    if (g->kind == BANDED && abs(row - col) > g->bandwidth)
+        return 0;
+    return counter_random(g->seed, 0, row, col) % VALUE_STEPS;
+}
+
+// Element value; ill-conditioned rows are graded from 1 down to 10^-exponent
+static double element_value(const generator_t *g, int row, int col) {
+    double value = (double)element_steps(g, row, col) / STEPS_PER_UNIT;
+    if (g->kind == ILL_CONDITIONED && g->rows > 1)
+        value *= pow(10.0, -g->condition_exponent * row / (g->rows - 1));
+    return value;
+}
+
+// Format steps / STEPS_PER_UNIT exactly with integer arithmetic ("12.345678")
+static int format_steps(uint64_t steps, char *buf) {
+    char digits[24];
+    int length = 0;
+    uint64_t integer = steps / STEPS_PER_UNIT, fraction = steps % STEPS_PER_UNIT;
+
+    do {
+        digits[length++] = '0' + integer % 10;
+        integer /= 10;
+    } while (integer);
+
+    char *ptr = buf;
+    while (length)
+        *ptr++ = digits[--length];
+    if (fraction) {
+        *ptr++ = '.';
+        for (uint64_t div = STEPS_PER_UNIT / 10; fraction && div; div /= 10) {
+            *ptr++ = '0' + fraction / div;
+            fraction %= div;
+        }
+    }
+    return ptr - buf;
+}
+
+// Format rows [start_row, end_row) as tab separated text, returns the length
+static size_t generate_text_rows(const void *source, int start_row, int end_row, char *buf) {
+    const generator_t *g = source;
+    char *ptr = buf;
+    for (int i = start_row; i < end_row; i++) {
+        for (int j = 0; j < g->cols; j++) {
+            if (g->kind == ILL_CONDITIONED)
+                ptr += format_double(element_value(g, i, j), ptr);
+            else
+                ptr += format_steps(element_steps(g, i, j), ptr);
+            *ptr++ = (j == g->cols - 1) ? '\n' : '\t';
+        }
+    }
+    return ptr - buf;
+}
+
+// Text: chunks of rows are formatted in parallel and written in order; the
+// output file is truncated, so only stdout needs sequential writes
+static size_t generate_text(const generator_t *g, int fd, int first_row, int end_row) {
+    long long bytes = write_text_chunks(fd, fd != STDOUT_FILENO, first_row, end_row,
+                                        (size_t)g->cols * MATRIX_TEXT_MAX_CHARS, generate_text_rows, g);
+    if (bytes < 0)
+        exit(EXIT_FAILURE);
+    return bytes;
+}
+
+// Binary: every row has a fixed offset, so chunks are generated and written in parallel
+static size_t generate_binary(const generator_t *g, int fd, int first_row, int end_row) {
+    size_t row_bytes = (size_t)g->cols * sizeof(double);
+    int chunk_rows = rows_per_chunk(row_bytes, end_row - first_row, omp_get_max_threads());
+    int num_chunks = (end_row - first_row + chunk_rows - 1) / chunk_rows;
+
+    matrix_bin_header header = { MATRIX_BIN_MAGIC, g->rows, g->cols, 0 };
+    if (write_all(fd, (const char *)&header, sizeof(header), 0, 1) != 0)
+        exit(EXIT_FAILURE);
+
+    #pragma omp parallel
+    {
+        double *buffer = malloc(chunk_rows * row_bytes);
+
+        #pragma omp for schedule(dynamic)
+        for (int c = 0; c < num_chunks; c++) {
+            int start_row = first_row + c * chunk_rows;
+            int stop_row = start_row + chunk_rows;
+            if (stop_row > end_row)
+                stop_row = end_row;
+
+            for (int i = start_row; i < stop_row; i++) {
+                double *row = buffer + (size_t)(i - start_row) * g->cols;
+                for (int j = 0; j < g->cols; j++) {
+                    row[j] = element_value(g, i, j);
+                }
+            }
+            if (write_all(fd, (const char *)buffer, (stop_row - start_row) * row_bytes,
+                          sizeof(header) + (off_t)start_row * row_bytes, 1) != 0)
+                exit(EXIT_FAILURE);
+        }
+
+        free(buffer);
+    }
+
+    return sizeof(header) + (size_t)(end_row - first_row) * row_bytes;
+}
+
+static void usage(const char *program) {
+    printf("Usage: %s [options] <rows> <cols> <output_file>\n", program);
+    printf("  -s seed       seed of the generator (default 1)\n");
+    printf("  -d kind       dense, sparse, banded or illcond (default dense)\n");
+    printf("  -p density    fraction of non-zeros for sparse (default 0.1)\n");
+    printf("  -w width      half bandwidth for banded (default 2)\n");
+    printf("  -k exponent   row scaling down to 10^-exponent for illcond (default 12)\n");
+    printf("  -r first:count  only generate rows first .. first+count-1\n");
+    printf("Output files ending in .bin are binary, \"-\" writes text to stdout.\n");
+    printf("Set OMP_NUM_THREADS environment variable to control threads\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    generator_t g = { DENSE, 1, 0.1, 2, 12.0, 0, 0 };
+    int first_row = 0, row_count = -1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:d:p:w:k:r:")) != -1) {
+        switch (opt) {
+        case 's':
+            g.seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'd':
+            if (strcmp(optarg, "dense") == 0)
+                g.kind = DENSE;
+            else if (strcmp(optarg, "sparse") == 0)
+                g.kind = SPARSE;
+            else if (strcmp(optarg, "banded") == 0)
+                g.kind = BANDED;
+            else if (strcmp(optarg, "illcond") == 0)
+                g.kind = ILL_CONDITIONED;
+            else
+                usage(argv[0]);
+            break;
+        case 'p':
+            g.density = atof(optarg);
+            break;
+        case 'w':
+            g.bandwidth = atoi(optarg);
+            break;
+        case 'k':
+            g.condition_exponent = atof(optarg);
+            break;
+        case 'r':
+            if (sscanf(optarg, "%d:%d", &first_row, &row_count) != 2)
+                usage(argv[0]);
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (argc - optind != 3)
+        usage(argv[0]);
+
+    g.rows = atoi(argv[optind]);
+    g.cols = atoi(argv[optind + 1]);
+    const char *output_file = argv[optind + 2];
+    if (row_count < 0)
+        row_count = g.rows - first_row;
+    int end_row = first_row + row_count;
+
+    if (g.rows <= 0 || g.cols <= 0 || first_row < 0 || row_count < 0 || end_row > g.rows) {
+        printf("Error: Invalid matrix size or row range\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!(g.density >= 0.0 && g.density <= 1.0) || g.bandwidth < 0 || !(g.condition_exponent >= 0.0)) {
+        printf("Error: Invalid density, bandwidth or condition exponent\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // A binary file is only truncated for a full matrix, so row ranges from
+    // several runs (or processes) fill one file
+    int binary = is_binary_path(output_file);
+    int flags = O_WRONLY | O_CREAT;
+    if (!binary || row_count == g.rows)
+        flags |= O_TRUNC;
+
+    int fd;
+    if (strcmp(output_file, "-") == 0)
+        fd = STDOUT_FILENO;
+    else
+        fd = open(output_file, flags, 0644);
+    if (fd < 0) {
+        perror("Error opening output file");
+        exit(EXIT_FAILURE);
+    }
+
+    double start_time = omp_get_wtime();
+    size_t bytes = binary ? generate_binary(&g, fd, first_row, end_row)
+                          : generate_text(&g, fd, first_row, end_row);
+    double end_time = omp_get_wtime();
+
+    if (fd != STDOUT_FILENO && close(fd) != 0) {
+        perror("Error closing output file");
+        exit(EXIT_FAILURE);
+    }
+
+    // Report on stderr so stdout stays clean when streaming text
+    fprintf(stderr, "Generated rows %d-%d of a %dx%d matrix in %s\n",
+            first_row, end_row - 1, g.rows, g.cols, output_file);
+    fprintf(stderr, "Output: %zu bytes in %.6f seconds (%.3f GB/s)\n", bytes, end_time - start_time,
+            end_time > start_time ? bytes / (end_time - start_time) / 1e9 : 0.0);
+
+    return 0;
+}
@@ -1,21 +1,55 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <omp.h>
 #include "matrix.h"
 
 
-// Allocate and read a matrix from a file
-matrix_struct *get_matrix_struct(const char *filename) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        perror("Error opening file");
-        exit(EXIT_FAILURE);
+// Allocate a rows x cols matrix (contents uninitialized)
+static matrix_struct *alloc_matrix(int rows, int cols) {
+    matrix_struct *m = malloc(sizeof(matrix_struct));
+    m->rows = rows;
+    m->cols = cols;
+    m->mat_data = malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++) {
+        m->mat_data[i] = malloc(cols * sizeof(double));
     }
+    return m;
+}
 
+// Read the rows following a binary header, returns NULL on failure
+static matrix_struct *read_binary_matrix(FILE *file, const matrix_bin_header *header,
+                                         const char *filename) {
+    if (header->rows <= 0 || header->cols <= 0) {
+        fprintf(stderr, "Error: Invalid binary matrix dimensions in %s\n", filename);
+        return NULL;
+    }
+
+    matrix_struct *m = alloc_matrix(header->rows, header->cols);
+    for (int i = 0; i < m->rows; i++) {
+        if (fread(m->mat_data[i], sizeof(double), m->cols, file) != (size_t)m->cols) {
+            fprintf(stderr, "Error reading binary matrix data at row %d\n", i);
+            free_matrix(m);
+            return NULL;
+        }
+    }
+    return m;
+}
+
+// Read a whitespace separated text matrix, returns NULL on failure
+static matrix_struct *read_text_matrix(FILE *file) {
     // First pass: count rows and columns
     int rows = 0, cols = 0;
-    char line[1024];
+    char *line = NULL;
+    size_t line_size = 0;
     
-    while (fgets(line, sizeof(line), file)) {
+    while (getline(&line, &line_size, file) != -1) {
         rows++;
         int current_cols = 0;
         char *ptr = line;
@@ -34,37 +68,61 @@ matrix_struct *get_matrix_struct(const char *filename) {
             cols = current_cols; // Set columns based on first line
         } else if (current_cols != cols) {
             fprintf(stderr, "Error: Inconsistent number of columns in row %d\n", rows);
-            fclose(file);
-            exit(EXIT_FAILURE);
+            free(line);
+            return NULL;
         }
     }
+    free(line);
 
     rewind(file);
 
     // Allocate matrix
-    matrix_struct *m = malloc(sizeof(matrix_struct));
-    m->rows = rows;
-    m->cols = cols;
-    m->mat_data = malloc(rows * sizeof(double *));
-    for (int i = 0; i < rows; i++) {
-        m->mat_data[i] = malloc(cols * sizeof(double));
-    }
+    matrix_struct *m = alloc_matrix(rows, cols);
 
     // Second pass: read the data
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
             if (fscanf(file, "%lf", &m->mat_data[i][j]) != 1) {
                 fprintf(stderr, "Error reading matrix data at row %d, col %d\n", i, j);
-                fclose(file);
-                exit(EXIT_FAILURE);
+                free_matrix(m);
+                return NULL;
             }
         }
     }
 
+    return m;
+}
+
+// Read a text or binary matrix from a file, returns NULL on failure
+matrix_struct *load_matrix(const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening file");
+        return NULL;
+    }
+
+    matrix_struct *m;
+    matrix_bin_header header;
+    if (fread(&header, sizeof(header), 1, file) == 1 &&
+        memcmp(header.magic, MATRIX_BIN_MAGIC, sizeof(header.magic)) == 0) {
+        m = read_binary_matrix(file, &header, filename);
+    } else {
+        rewind(file);
+        m = read_text_matrix(file);
+    }
+
     fclose(file);
     return m;
 }
 
+// Allocate and read a matrix from a file
+matrix_struct *get_matrix_struct(const char *filename) {
+    matrix_struct *m = load_matrix(filename);
+    if (!m)
+        exit(EXIT_FAILURE);
+    return m;
+}
+
 
 // Print matrix to stdout
 void print_matrix(matrix_struct *m) {
@@ -83,3 +141,453 @@ void free_matrix(matrix_struct *m) {
     free(m);
 }
 
+// Grisu3 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+// with Integers"): the shortest digits are generated with 64-bit integer
+// arithmetic from a cached power of ten. For the rare values where the
+// 64-bit precision cannot prove the result shortest and correctly rounded,
+// format_double falls back to searching with snprintf/strtod.
+typedef struct {
+    uint64_t f;
+    int e;
+} diy_fp;
+
+// Normalized 10^k for k = -348, -340, ..., 340, as f * 2^e
+static const diy_fp cached_powers[] = {
+    { 0xfa8fd5a0081c0288ULL, -1220 }, { 0xbaaee17fa23ebf76ULL, -1193 }, { 0x8b16fb203055ac76ULL, -1166 },
+    { 0xcf42894a5dce35eaULL, -1140 }, { 0x9a6bb0aa55653b2dULL, -1113 }, { 0xe61acf033d1a45dfULL, -1087 },
+    { 0xab70fe17c79ac6caULL, -1060 }, { 0xff77b1fcbebcdc4fULL, -1034 }, { 0xbe5691ef416bd60cULL, -1007 },
+    { 0x8dd01fad907ffc3cULL, -980 }, { 0xd3515c2831559a83ULL, -954 }, { 0x9d71ac8fada6c9b5ULL, -927 },
+    { 0xea9c227723ee8bcbULL, -901 }, { 0xaecc49914078536dULL, -874 }, { 0x823c12795db6ce57ULL, -847 },
+    { 0xc21094364dfb5637ULL, -821 }, { 0x9096ea6f3848984fULL, -794 }, { 0xd77485cb25823ac7ULL, -768 },
+    { 0xa086cfcd97bf97f4ULL, -741 }, { 0xef340a98172aace5ULL, -715 }, { 0xb23867fb2a35b28eULL, -688 },
+    { 0x84c8d4dfd2c63f3bULL, -661 }, { 0xc5dd44271ad3cdbaULL, -635 }, { 0x936b9fcebb25c996ULL, -608 },
+    { 0xdbac6c247d62a584ULL, -582 }, { 0xa3ab66580d5fdaf6ULL, -555 }, { 0xf3e2f893dec3f126ULL, -529 },
+    { 0xb5b5ada8aaff80b8ULL, -502 }, { 0x87625f056c7c4a8bULL, -475 }, { 0xc9bcff6034c13053ULL, -449 },
+    { 0x964e858c91ba2655ULL, -422 }, { 0xdff9772470297ebdULL, -396 }, { 0xa6dfbd9fb8e5b88fULL, -369 },
+    { 0xf8a95fcf88747d94ULL, -343 }, { 0xb94470938fa89bcfULL, -316 }, { 0x8a08f0f8bf0f156bULL, -289 },
+    { 0xcdb02555653131b6ULL, -263 }, { 0x993fe2c6d07b7facULL, -236 }, { 0xe45c10c42a2b3b06ULL, -210 },
+    { 0xaa242499697392d3ULL, -183 }, { 0xfd87b5f28300ca0eULL, -157 }, { 0xbce5086492111aebULL, -130 },
+    { 0x8cbccc096f5088ccULL, -103 }, { 0xd1b71758e219652cULL, -77 }, { 0x9c40000000000000ULL, -50 },
+    { 0xe8d4a51000000000ULL, -24 }, { 0xad78ebc5ac620000ULL, 3 }, { 0x813f3978f8940984ULL, 30 },
+    { 0xc097ce7bc90715b3ULL, 56 }, { 0x8f7e32ce7bea5c70ULL, 83 }, { 0xd5d238a4abe98068ULL, 109 },
+    { 0x9f4f2726179a2245ULL, 136 }, { 0xed63a231d4c4fb27ULL, 162 }, { 0xb0de65388cc8ada8ULL, 189 },
+    { 0x83c7088e1aab65dbULL, 216 }, { 0xc45d1df942711d9aULL, 242 }, { 0x924d692ca61be758ULL, 269 },
+    { 0xda01ee641a708deaULL, 295 }, { 0xa26da3999aef774aULL, 322 }, { 0xf209787bb47d6b85ULL, 348 },
+    { 0xb454e4a179dd1877ULL, 375 }, { 0x865b86925b9bc5c2ULL, 402 }, { 0xc83553c5c8965d3dULL, 428 },
+    { 0x952ab45cfa97a0b3ULL, 455 }, { 0xde469fbd99a05fe3ULL, 481 }, { 0xa59bc234db398c25ULL, 508 },
+    { 0xf6c69a72a3989f5cULL, 534 }, { 0xb7dcbf5354e9beceULL, 561 }, { 0x88fcf317f22241e2ULL, 588 },
+    { 0xcc20ce9bd35c78a5ULL, 614 }, { 0x98165af37b2153dfULL, 641 }, { 0xe2a0b5dc971f303aULL, 667 },
+    { 0xa8d9d1535ce3b396ULL, 694 }, { 0xfb9b7cd9a4a7443cULL, 720 }, { 0xbb764c4ca7a44410ULL, 747 },
+    { 0x8bab8eefb6409c1aULL, 774 }, { 0xd01fef10a657842cULL, 800 }, { 0x9b10a4e5e9913129ULL, 827 },
+    { 0xe7109bfba19c0c9dULL, 853 }, { 0xac2820d9623bf429ULL, 880 }, { 0x80444b5e7aa7cf85ULL, 907 },
+    { 0xbf21e44003acdd2dULL, 933 }, { 0x8e679c2f5e44ff8fULL, 960 }, { 0xd433179d9c8cb841ULL, 986 },
+    { 0x9e19db92b4e31ba9ULL, 1013 }, { 0xeb96bf6ebadf77d9ULL, 1039 }, { 0xaf87023b9bf0ee6bULL, 1066 }
+};
+
+static const uint64_t powers_of_ten[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+// Product of two 64-bit significands, rounded to the upper 64 bits
+static diy_fp diy_fp_multiply(diy_fp x, diy_fp y) {
+    unsigned __int128 product = (unsigned __int128)x.f * y.f;
+    diy_fp result = { (uint64_t)(product >> 64) + (uint64_t)((product >> 63) & 1), x.e + y.e + 64 };
+    return result;
+}
+
+static diy_fp diy_fp_normalize(diy_fp x) {
+    int shift = __builtin_clzll(x.f);
+    diy_fp result = { x.f << shift, x.e - shift };
+    return result;
+}
+
+// Cached power c with c * 2^e_max landing in the digit generation range, 10^-k = c
+static diy_fp cached_power(int e, int *k) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int index = (int)dk;
+    if (dk - index > 0.0)
+        index++;
+    index = (index >> 3) + 1;
+    *k = -(-348 + index * 8);
+    return cached_powers[index];
+}
+
+// Move the last digit towards w while that stays inside the safe interval.
+// Returns 0 when the 64-bit precision cannot tell which result is correct.
+static int round_weed(char *digits, int length, uint64_t distance_too_high_w,
+                      uint64_t unsafe_interval, uint64_t rest, uint64_t ten_kappa, uint64_t unit) {
+    uint64_t small_distance = distance_too_high_w - unit;
+    uint64_t big_distance = distance_too_high_w + unit;
+
+    while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+           (rest + ten_kappa < small_distance ||
+            small_distance - rest >= rest + ten_kappa - small_distance)) {
+        digits[length - 1]--;
+        rest += ten_kappa;
+    }
+
+    if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+        (rest + ten_kappa < big_distance ||
+         big_distance - rest > rest + ten_kappa - big_distance))
+        return 0;
+
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+// Generate digits from the upper boundary until the number lies within the
+// (unsafe) interval between the scaled boundaries low and high
+static int grisu_digits(diy_fp low, diy_fp w, diy_fp high, char *digits, int *length, int *kappa) {
+    uint64_t unit = 1;
+    diy_fp too_low = { low.f - unit, low.e };
+    diy_fp too_high = { high.f + unit, high.e };
+    uint64_t unsafe_interval = too_high.f - too_low.f;
+    diy_fp one = { 1ULL << -w.e, w.e };
+    uint32_t integrals = (uint32_t)(too_high.f >> -one.e);
+    uint64_t fractionals = too_high.f & (one.f - 1);
+
+    *kappa = 1;
+    while (*kappa < 10 && integrals >= powers_of_ten[*kappa])
+        (*kappa)++;
+    *length = 0;
+
+    while (*kappa > 0) {
+        uint64_t divisor = powers_of_ten[*kappa - 1];
+        digits[(*length)++] = '0' + integrals / divisor;
+        integrals %= divisor;
+        (*kappa)--;
+
+        uint64_t rest = ((uint64_t)integrals << -one.e) + fractionals;
+        if (rest < unsafe_interval)
+            return round_weed(digits, *length, too_high.f - w.f, unsafe_interval, rest,
+                              divisor << -one.e, unit);
+    }
+
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digits[(*length)++] = '0' + (fractionals >> -one.e);
+        fractionals &= one.f - 1;
+        (*kappa)--;
+
+        if (fractionals < unsafe_interval)
+            return round_weed(digits, *length, (too_high.f - w.f) * unit, unsafe_interval,
+                              fractionals, one.f, unit);
+    }
+}
+
+// Shortest digits of a positive finite double: value = digits * 10^k.
+// Returns the number of digits, or 0 if the fallback is needed.
+static int grisu3(double value, char *digits, int *k) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased_e = (int)(bits >> 52) & 0x7FF;
+    uint64_t significand = bits & 0xFFFFFFFFFFFFFULL;
+
+    diy_fp v;
+    if (biased_e) {
+        v.f = significand | (1ULL << 52);
+        v.e = biased_e - 1075;
+    } else {
+        v.f = significand;
+        v.e = -1074;
+    }
+
+    // Boundaries halfway to the neighbouring doubles, on the exponent of w
+    diy_fp w = diy_fp_normalize(v);
+    diy_fp plus = { (v.f << 1) + 1, v.e - 1 };
+    plus = diy_fp_normalize(plus);
+    diy_fp minus;
+    if (v.f == (1ULL << 52) && biased_e > 1) {
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    } else {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    diy_fp c_mk = cached_power(plus.e, k);
+    int length, kappa;
+    if (!grisu_digits(diy_fp_multiply(minus, c_mk), diy_fp_multiply(w, c_mk),
+                      diy_fp_multiply(plus, c_mk), digits, &length, &kappa))
+        return 0;
+
+    *k += kappa;
+    return length;
+}
+
+// Fallback: fewest of 15, 16 or 17 significant digits that read back exactly
+static int shortest_digits_slow(double value, char *digits, int *k) {
+    char buf[32];
+    for (int precision = 15; precision <= 17; precision++) {
+        snprintf(buf, sizeof(buf), "%.*e", precision - 1, value);
+        if (precision == 17 || strtod(buf, NULL) == value)
+            break;
+    }
+
+    // buf is "d.ddddde+XX": collect the digits without trailing zeros
+    int length = 0;
+    char *ptr = buf;
+    for (; *ptr != 'e'; ptr++) {
+        if (*ptr != '.')
+            digits[length++] = *ptr;
+    }
+    int exponent = atoi(ptr + 1);
+    while (length > 1 && digits[length - 1] == '0')
+        length--;
+
+    *k = exponent - length + 1;
+    return length;
+}
+
+// Format a double in the style of "%g" using the shortest digits that
+// still parse back to the same value
+int format_double(double value, char *buf) {
+    char *ptr = buf;
+
+    if (isnan(value))
+        return sprintf(buf, "nan");
+    if (signbit(value)) {
+        *ptr++ = '-';
+        value = -value;
+    }
+    if (isinf(value))
+        return ptr - buf + sprintf(ptr, "inf");
+    if (value == 0.0) {
+        *ptr++ = '0';
+        *ptr = '\0';
+        return ptr - buf;
+    }
+
+    char digits[20];
+    int k;
+    int length = grisu3(value, digits, &k);
+    if (!length)
+        length = shortest_digits_slow(value, digits, &k);
+    int exponent = length + k - 1;
+
+    if (exponent < -4 || exponent >= 17) {
+        // d.ddde+XX
+        *ptr++ = digits[0];
+        if (length > 1) {
+            *ptr++ = '.';
+            memcpy(ptr, digits + 1, length - 1);
+            ptr += length - 1;
+        }
+        ptr += sprintf(ptr, "e%c%02d", exponent < 0 ? '-' : '+', abs(exponent));
+        return ptr - buf;
+    }
+
+    if (k >= 0) {
+        // Integer: digits followed by zeros
+        memcpy(ptr, digits, length);
+        ptr += length;
+        memset(ptr, '0', k);
+        ptr += k;
+    } else if (exponent >= 0) {
+        // Decimal point inside the digits
+        memcpy(ptr, digits, exponent + 1);
+        ptr += exponent + 1;
+        *ptr++ = '.';
+        memcpy(ptr, digits + exponent + 1, length - exponent - 1);
+        ptr += length - exponent - 1;
+    } else {
+        // 0.000ddd
+        *ptr++ = '0';
+        *ptr++ = '.';
+        memset(ptr, '0', -exponent - 1);
+        ptr += -exponent - 1;
+        memcpy(ptr, digits, length);
+        ptr += length;
+    }
+    *ptr = '\0';
+    return ptr - buf;
+}
+
+// Format one row as tab separated text with a trailing newline, returns the length
+size_t format_row_text(const double *row, int cols, char *buf) {
+    char *ptr = buf;
+    for (int j = 0; j < cols; j++) {
+        ptr += format_double(row[j], ptr);
+        *ptr++ = (j == cols - 1) ? '\n' : '\t';
+    }
+    return ptr - buf;
+}
+
+// Returns 1 if the file name asks for the binary format
+int is_binary_path(const char *filename) {
+    size_t length = strlen(filename);
+    return length >= 4 && strcmp(filename + length - 4, ".bin") == 0;
+}
+
+// Write the whole buffer, at the given offset if positioned (pwrite) or at
+// the current file position otherwise. Retries short writes, returns 0 on success.
+int write_all(int fd, const char *buf, size_t length, off_t offset, int positioned) {
+    while (length > 0) {
+        ssize_t written = positioned ? pwrite(fd, buf, length, offset) : write(fd, buf, length);
+        if (written < 0) {
+            perror("Error writing output file");
+            return -1;
+        }
+        buf += written;
+        length -= written;
+        offset += written;
+    }
+    return 0;
+}
+
+// Rows per chunk for rows of row_bytes: every chunk gets a share of the rows,
+// capped by MATRIX_CHUNK_BYTES
+int rows_per_chunk(size_t row_bytes, int rows, int num_chunks) {
+    size_t chunk_rows = MATRIX_CHUNK_BYTES / row_bytes;
+    int rows_per_thread = (rows + num_chunks - 1) / num_chunks;
+    if (chunk_rows > (size_t)rows_per_thread)
+        chunk_rows = rows_per_thread;
+    return chunk_rows < 1 ? 1 : (int)chunk_rows;
+}
+
+// Write the header and rows through a shared mapping of the output file
+static long long write_matrix_binary(matrix_struct *m, int fd) {
+    size_t row_bytes = (size_t)m->cols * sizeof(double);
+    size_t total = sizeof(matrix_bin_header) + (size_t)m->rows * row_bytes;
+
+    // Allocate the blocks up front: a full disk is reported here instead of
+    // raising SIGBUS while the mapping is written
+    int status = posix_fallocate(fd, 0, total);
+    if (status != 0) {
+        errno = status;
+        perror("Error allocating output file");
+        return -1;
+    }
+    char *map = mmap(NULL, total, PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        perror("Error mapping output file");
+        return -1;
+    }
+
+    matrix_bin_header header = { MATRIX_BIN_MAGIC, m->rows, m->cols, 0 };
+    memcpy(map, &header, sizeof(header));
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < m->rows; i++) {
+        memcpy(map + sizeof(header) + i * row_bytes, m->mat_data[i], row_bytes);
+    }
+
+    munmap(map, total);
+    return total;
+}
+
+// Format rows [first_row, end_row) in parallel chunks and write them in order.
+// Chunks are processed in rounds so the buffers stay bounded for large outputs.
+// Positioned output writes every chunk at its final offset in parallel,
+// otherwise (e.g. a pipe) the chunks are written one after another.
+long long write_text_chunks(int fd, int positioned, int first_row, int end_row,
+                            size_t row_capacity, format_rows_fn format, const void *source) {
+    int num_chunks = omp_get_max_threads();
+    int chunk_rows = rows_per_chunk(row_capacity, end_row - first_row, num_chunks);
+
+    char **buffers = malloc(num_chunks * sizeof(char *));
+    size_t *lengths = malloc(num_chunks * sizeof(size_t));
+    size_t *offsets = malloc(num_chunks * sizeof(size_t));
+    for (int c = 0; c < num_chunks; c++) {
+        buffers[c] = malloc(chunk_rows * row_capacity);
+    }
+
+    size_t total = 0;
+    int failed = 0;
+    for (int round_start = first_row; round_start < end_row; round_start += num_chunks * chunk_rows) {
+        #pragma omp parallel for schedule(static)
+        for (int c = 0; c < num_chunks; c++) {
+            long start_row = round_start + (long)c * chunk_rows;
+            long stop_row = start_row + chunk_rows;
+            if (stop_row > end_row)
+                stop_row = end_row;
+
+            lengths[c] = start_row < stop_row ? format(source, start_row, stop_row, buffers[c]) : 0;
+        }
+
+        for (int c = 0; c < num_chunks; c++) {
+            offsets[c] = total;
+            total += lengths[c];
+        }
+
+        if (positioned) {
+            #pragma omp parallel for schedule(static) reduction(|:failed)
+            for (int c = 0; c < num_chunks; c++) {
+                failed |= write_all(fd, buffers[c], lengths[c], offsets[c], 1) != 0;
+            }
+        } else {
+            for (int c = 0; c < num_chunks && !failed; c++) {
+                failed = write_all(fd, buffers[c], lengths[c], 0, 0) != 0;
+            }
+        }
+        if (failed)
+            break;
+    }
+
+    for (int c = 0; c < num_chunks; c++) {
+        free(buffers[c]);
+    }
+    free(buffers);
+    free(lengths);
+    free(offsets);
+    return failed ? -1 : (long long)total;
+}
+
+static size_t format_matrix_rows(const void *source, int start_row, int end_row, char *buf) {
+    const matrix_struct *m = source;
+    size_t length = 0;
+    for (int i = start_row; i < end_row; i++) {
+        length += format_row_text(m->mat_data[i], m->cols, buf + length);
+    }
+    return length;
+}
+
+// Write a matrix to a file (binary for ".bin" names, text otherwise),
+// returns the bytes written or -1 on failure
+long long store_matrix(matrix_struct *m, const char *filename) {
+    int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("Error opening output file");
+        return -1;
+    }
+
+    long long bytes = is_binary_path(filename)
+                          ? write_matrix_binary(m, fd)
+                          : write_text_chunks(fd, 1, 0, m->rows, (size_t)m->cols * MATRIX_TEXT_MAX_CHARS,
+                                              format_matrix_rows, m);
+
+    if (close(fd) != 0) {
+        perror("Error closing output file");
+        return -1;
+    }
+    return bytes;
+}
+
+// Write a matrix to a file, returns the bytes written
+size_t write_matrix(matrix_struct *m, const char *filename) {
+    long long bytes = store_matrix(m, filename);
+    if (bytes < 0)
+        exit(EXIT_FAILURE);
+    return bytes;
+}
+
+// Print the output line picked up by the benchmark report
+void print_output_report(size_t bytes, double seconds) {
+    double gb_per_second = seconds > 0.0 ? bytes / seconds / 1e9 : 0.0;
+    printf("Output: %zu bytes in %.6f seconds (%.3f GB/s)\n", bytes, seconds, gb_per_second);
+}
+
+// Write a matrix to a file and report the output speed
+void save_matrix(matrix_struct *m, const char *filename) {
+    double start_time = omp_get_wtime();
+    size_t bytes = write_matrix(m, filename);
+    double end_time = omp_get_wtime();
+
+    print_output_report(bytes, end_time - start_time);
+}
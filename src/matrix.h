@@ -1,15 +1,50 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <stddef.h>
+#include <sys/types.h>
+
 typedef struct {
     int rows;
     int cols;
     double **mat_data;
 } matrix_struct;
 
+// Binary matrix files start with this header, followed by rows * cols
+// doubles in row-major order. Files ending in ".bin" are written this way.
+#define MATRIX_BIN_MAGIC "MATB"
+
+typedef struct {
+    char magic[4];
+    int rows;
+    int cols;
+    int reserved;
+} matrix_bin_header;
+
+// Upper bound of characters one formatted element needs, separator included
+#define MATRIX_TEXT_MAX_CHARS 25
+
+// Rows are produced and written in rounds of this many bytes per thread
+#define MATRIX_CHUNK_BYTES (8 * 1024 * 1024)
+
+// Formats rows [start_row, end_row) of source as text into buf, returns the length
+typedef size_t (*format_rows_fn)(const void *source, int start_row, int end_row, char *buf);
+
+matrix_struct *load_matrix(const char *filename);
 matrix_struct *get_matrix_struct(const char *filename);
 void print_matrix(matrix_struct *matrix_to_print);
 void free_matrix(matrix_struct *matrix_to_free);
 
-#endif
+int format_double(double value, char *buf);
+size_t format_row_text(const double *row, int cols, char *buf);
+int is_binary_path(const char *filename);
+int rows_per_chunk(size_t row_bytes, int rows, int num_chunks);
+int write_all(int fd, const char *buf, size_t length, off_t offset, int positioned);
+long long write_text_chunks(int fd, int positioned, int first_row, int end_row,
+                            size_t row_capacity, format_rows_fn format, const void *source);
+long long store_matrix(matrix_struct *matrix_to_store, const char *filename);
+size_t write_matrix(matrix_struct *matrix_to_write, const char *filename);
+void print_output_report(size_t bytes, double seconds);
+void save_matrix(matrix_struct *matrix_to_save, const char *filename);
 
+#endif
@@ -1,8 +1,76 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include <mpi.h>
 #include "matrix.h"
 
+// Largest text piece handed to one MPI-IO call, keeps the int count in range
+#define MPI_WRITE_PIECE_BYTES (1 << 30)
+
+// Write each process's rows of the result with collective MPI-IO, returns the total bytes written
+static long long write_result_collective(const char *filename, const double *local_result,
+                                         int start_row, int local_rows, int rows, int cols) {
+    int rank;
+    MPI_File file;
+    long long total = 0;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (MPI_File_open(MPI_COMM_WORLD, filename, MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                      MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        if (rank == 0)
+            fprintf(stderr, "Error opening output file %s\n", filename);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+    MPI_File_set_size(file, 0);
+
+    if (is_binary_path(filename)) {
+        matrix_bin_header header = { MATRIX_BIN_MAGIC, rows, cols, 0 };
+        if (rank == 0)
+            MPI_File_write_at(file, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+
+        // Write whole rows as one element each, so the count stays below 2^31
+        MPI_Datatype row_type;
+        MPI_Type_contiguous(cols, MPI_DOUBLE, &row_type);
+        MPI_Type_commit(&row_type);
+
+        MPI_Offset offset = sizeof(header) + (MPI_Offset)start_row * cols * sizeof(double);
+        MPI_File_write_at_all(file, offset, local_result, local_rows, row_type, MPI_STATUS_IGNORE);
+        MPI_Type_free(&row_type);
+        total = sizeof(header) + (long long)rows * cols * sizeof(double);
+    } else {
+        // Each process formats its own rows, the exclusive prefix sum gives its file offset
+        char *buffer = malloc((size_t)local_rows * cols * MATRIX_TEXT_MAX_CHARS + 1);
+        long long length = 0, offset = 0;
+        for (int i = 0; i < local_rows; i++) {
+            length += format_row_text(local_result + (size_t)i * cols, cols, buffer + length);
+        }
+
+        MPI_Exscan(&length, &offset, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+        if (rank == 0)
+            offset = 0;
+
+        // Collective writes in bounded pieces, every process joins every round
+        long long pieces = (length + MPI_WRITE_PIECE_BYTES - 1) / MPI_WRITE_PIECE_BYTES, rounds;
+        MPI_Allreduce(&pieces, &rounds, 1, MPI_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+        for (long long piece = 0; piece < rounds; piece++) {
+            long long piece_start = piece * MPI_WRITE_PIECE_BYTES;
+            long long piece_length = length - piece_start;
+            if (piece_length > MPI_WRITE_PIECE_BYTES)
+                piece_length = MPI_WRITE_PIECE_BYTES;
+            if (piece_length < 0)
+                piece_length = 0;
+
+            MPI_File_write_at_all(file, offset + piece_start, buffer + (piece_length ? piece_start : 0),
+                                  (int)piece_length, MPI_CHAR, MPI_STATUS_IGNORE);
+        }
+        MPI_Allreduce(&length, &total, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+        free(buffer);
+    }
+
+    MPI_File_close(&file);
+    return total;
+}
+
 int main(int argc, char *argv[]) {
     int num_procs, rank;
     matrix_struct *matrix_a = NULL, *matrix_b = NULL, *result = NULL;
@@ -13,15 +81,23 @@ int main(int argc, char *argv[]) {
     MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
+    // Parse the optional output file (every process takes part in writing it)
+    const char *output_file = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        if (opt == 'o')
+            output_file = optarg;
+    }
+
     // Master process reads matrices
     if (rank == 0) {
-        if (argc != 3) {
-            printf("Usage: mpirun -n <processes> ./mpi <matrix_a> <matrix_b>\n");
+        if (argc - optind != 2) {
+            printf("Usage: mpirun -n <processes> ./mpi [-o output_file] <matrix_a> <matrix_b>\n");
             MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
         }
 
-        matrix_a = get_matrix_struct(argv[1]);
-        matrix_b = get_matrix_struct(argv[2]);
+        matrix_a = get_matrix_struct(argv[optind]);
+        matrix_b = get_matrix_struct(argv[optind + 1]);
 
         if (matrix_a->cols != matrix_b->rows) {
             printf("Error: Matrix dimensions incompatible for multiplication\n");
@@ -156,6 +232,17 @@ int main(int argc, char *argv[]) {
         free(displs);
     }
 
+    // Write the full result if requested
+    if (output_file) {
+        double output_start = MPI_Wtime();
+        long long bytes = write_result_collective(output_file, flat_result + (size_t)start_row * cols_result,
+                                                  start_row, local_rows, rows_result, cols_result);
+        double output_end = MPI_Wtime();
+
+        if (rank == 0)
+            print_output_report(bytes, output_end - output_start);
+    }
+
     free(flat_a);
     free(flat_b);
     free(flat_result);
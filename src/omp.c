@@ -1,19 +1,28 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include "matrix.h"
 #include <omp.h>
 
 int main(int argc, char **argv)
 {
-    if (argc != 3) {
-        printf("Usage: %s <matrix_a> <matrix_b>\n", argv[0]);
+    // Parse the optional output file
+    const char *output_file = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        if (opt == 'o')
+            output_file = optarg;
+    }
+
+    if (argc - optind != 2) {
+        printf("Usage: %s [-o output_file] <matrix_a> <matrix_b>\n", argv[0]);
         printf("Set OMP_NUM_THREADS environment variable to control threads\n");
         exit(EXIT_FAILURE);
     }
 
     // Read matrices
-    matrix_struct *matrix_a = get_matrix_struct(argv[1]);
-    matrix_struct *matrix_b = get_matrix_struct(argv[2]);
+    matrix_struct *matrix_a = get_matrix_struct(argv[optind]);
+    matrix_struct *matrix_b = get_matrix_struct(argv[optind + 1]);
 
     // Validate dimensions
     if (matrix_a->cols != matrix_b->rows) {
@@ -82,6 +91,11 @@ int main(int argc, char **argv)
         }
     }
 
+    // Write the full result if requested
+    if (output_file) {
+        save_matrix(result, output_file);
+    }
+
     // Cleanup
     free_matrix(matrix_a);
     free_matrix(matrix_b);
@@ -0,0 +1,748 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "matrix.h"
+
+#define DEFAULT_SOCKET_PATH "/tmp/matrix.sock"
+#define DEFAULT_CACHE_ENTRIES 8
+#define MAX_REQUEST_LENGTH 4096
+#define ROWS_PER_TASK 8
+#define REQUEST_TIMEOUT_MS 5000
+#define ACCEPT_POLL_MS 200
+
+// Multiplication the warm pool is currently working on: C = A * B with B
+// stored transposed, so every element is a dot product of two contiguous rows
+typedef struct {
+    const double *flat_a;
+    const double *transposed_b;
+    double *flat_result;
+    int rows;
+    int cols;
+    int inner_dim;
+    int next_row;
+} multiply_job_t;
+
+// Worker threads stay alive between requests and wait for the next job
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    pthread_t *threads;
+    int num_threads;
+    int generation;
+    int active;
+    int shutdown;
+    multiply_job_t *job;
+} thread_pool_t;
+
+// Loaded and pre-packed operand, keyed by path, mtime and size
+typedef struct {
+    char *path;
+    struct timespec mtime;
+    off_t size;
+    int rows;
+    int cols;
+    double *flat;
+    double *transposed;
+    unsigned long last_used;
+} cache_entry_t;
+
+// Accepted request waiting for the dispatcher
+typedef struct request {
+    int fd;
+    char line[MAX_REQUEST_LENGTH];
+    double enqueue_time;
+    struct request *next;
+} request_t;
+
+static thread_pool_t pool;
+
+static cache_entry_t *cache;
+static int cache_capacity;
+static unsigned long cache_clock;
+
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_ready = PTHREAD_COND_INITIALIZER;
+static request_t *queue_head, *queue_tail;
+
+// Connection threads still running, shutdown waits for them before the
+// dispatcher is stopped so no job is queued behind the stop request
+static int active_connections;
+static pthread_cond_t connections_done = PTHREAD_COND_INITIALIZER;
+
+// Request metrics, protected by queue_lock
+static int queue_depth, max_queue_depth;
+static unsigned long requests_done, requests_failed, cache_hits, cache_misses;
+static double total_wait_time, total_latency, max_latency;
+
+static volatile sig_atomic_t stop_requested;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void handle_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+// Create a thread with SIGINT/SIGTERM blocked, so only the main thread handles them
+static int create_thread(pthread_t *thread, const pthread_attr_t *attr,
+                         void *(*start)(void *), void *arg) {
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTERM);
+
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+    int status = pthread_create(thread, attr, start, arg);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    return status;
+}
+
+// Separators between the words of a request line
+#define REQUEST_SEPARATORS " \t\r\n"
+
+// Returns 1 if the first word of the request line is exactly the command
+static int is_command(const char *line, const char *command) {
+    size_t length = strlen(command);
+    return strncmp(line, command, length) == 0 &&
+           (line[length] == '\0' || strchr(REQUEST_SEPARATORS, line[length]));
+}
+
+// Worker thread: take blocks of rows of the current job until none are left
+static void *pool_worker(void *arg) {
+    (void)arg;
+    int seen_generation = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&pool.lock);
+        while (pool.generation == seen_generation && !pool.shutdown)
+            pthread_cond_wait(&pool.work_ready, &pool.lock);
+        if (pool.shutdown) {
+            pthread_mutex_unlock(&pool.lock);
+            break;
+        }
+        seen_generation = pool.generation;
+        multiply_job_t *job = pool.job;
+        pthread_mutex_unlock(&pool.lock);
+
+        int start_row;
+        while ((start_row = __sync_fetch_and_add(&job->next_row, ROWS_PER_TASK)) < job->rows) {
+            int end_row = start_row + ROWS_PER_TASK;
+            if (end_row > job->rows)
+                end_row = job->rows;
+
+            for (int i = start_row; i < end_row; i++) {
+                const double *row_a = job->flat_a + (size_t)i * job->inner_dim;
+                for (int j = 0; j < job->cols; j++) {
+                    const double *col_b = job->transposed_b + (size_t)j * job->inner_dim;
+                    double sum = 0.0;
+                    for (int k = 0; k < job->inner_dim; k++) {
+                        sum += row_a[k] * col_b[k];
+                    }
+                    job->flat_result[(size_t)i * job->cols + j] = sum;
+                }
+            }
+        }
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.active == 0)
+            pthread_cond_signal(&pool.work_done);
+        pthread_mutex_unlock(&pool.lock);
+    }
+
+    return NULL;
+}
+
+static void pool_start(int num_threads) {
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.work_ready, NULL);
+    pthread_cond_init(&pool.work_done, NULL);
+    pool.num_threads = num_threads;
+    pool.threads = malloc(num_threads * sizeof(pthread_t));
+    for (int i = 0; i < num_threads; i++) {
+        create_thread(&pool.threads[i], NULL, pool_worker, NULL);
+    }
+}
+
+static void pool_stop(void) {
+    pthread_mutex_lock(&pool.lock);
+    pool.shutdown = 1;
+    pthread_cond_broadcast(&pool.work_ready);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int i = 0; i < pool.num_threads; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+    free(pool.threads);
+}
+
+// Hand a job to the warm workers and wait until all of them are done
+static void pool_run(multiply_job_t *job) {
+    pthread_mutex_lock(&pool.lock);
+    pool.job = job;
+    pool.active = pool.num_threads;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.work_ready);
+    while (pool.active > 0)
+        pthread_cond_wait(&pool.work_done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+}
+
+static void free_cache_entry(cache_entry_t *entry) {
+    free(entry->path);
+    free(entry->flat);
+    free(entry->transposed);
+    memset(entry, 0, sizeof(*entry));
+}
+
+// Return the cached operand for a path, loading it (and evicting the least
+// recently used entry) when the file is new or has changed on disk
+static cache_entry_t *cache_lookup(const char *path, char *error, size_t error_size) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        snprintf(error, error_size, "cannot stat %s: %s", path, strerror(errno));
+        return NULL;
+    }
+
+    cache_entry_t *slot = NULL;
+    for (int i = 0; i < cache_capacity; i++) {
+        cache_entry_t *entry = &cache[i];
+        if (entry->path && strcmp(entry->path, path) == 0) {
+            if (entry->size == st.st_size &&
+                entry->mtime.tv_sec == st.st_mtim.tv_sec &&
+                entry->mtime.tv_nsec == st.st_mtim.tv_nsec) {
+                entry->last_used = ++cache_clock;
+                pthread_mutex_lock(&queue_lock);
+                cache_hits++;
+                pthread_mutex_unlock(&queue_lock);
+                return entry;
+            }
+            // Stale entry for the same path is reloaded in place
+            slot = entry;
+            break;
+        }
+    }
+
+    // Otherwise take a free slot, or evict the least recently used one
+    for (int i = 0; !slot && i < cache_capacity; i++) {
+        if (!cache[i].path)
+            slot = &cache[i];
+    }
+    if (!slot) {
+        slot = &cache[0];
+        for (int i = 1; i < cache_capacity; i++) {
+            if (cache[i].last_used < slot->last_used)
+                slot = &cache[i];
+        }
+    }
+
+    matrix_struct *m = load_matrix(path);
+    if (!m) {
+        snprintf(error, error_size, "cannot load %s", path);
+        return NULL;
+    }
+
+    free_cache_entry(slot);
+    slot->path = strdup(path);
+    slot->mtime = st.st_mtim;
+    slot->size = st.st_size;
+    slot->rows = m->rows;
+    slot->cols = m->cols;
+    slot->flat = malloc((size_t)m->rows * m->cols * sizeof(double));
+    for (int i = 0; i < m->rows; i++) {
+        memcpy(slot->flat + (size_t)i * m->cols, m->mat_data[i], m->cols * sizeof(double));
+    }
+    slot->last_used = ++cache_clock;
+    free_matrix(m);
+
+    pthread_mutex_lock(&queue_lock);
+    cache_misses++;
+    pthread_mutex_unlock(&queue_lock);
+    return slot;
+}
+
+// Transposed copy of a row-major rows x cols matrix
+static double *transpose(const double *flat, int rows, int cols) {
+    double *transposed = malloc((size_t)rows * cols * sizeof(double));
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            transposed[(size_t)j * rows + i] = flat[(size_t)i * cols + j];
+        }
+    }
+    return transposed;
+}
+
+// Map a shared memory object holding a binary matrix, returns the header or NULL.
+// st receives the object's identity for the aliasing check on the result.
+static matrix_bin_header *map_shm_matrix(const char *name, size_t *length, struct stat *st,
+                                         char *error, size_t error_size) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        snprintf(error, error_size, "cannot open shared memory %s: %s", name, strerror(errno));
+        return NULL;
+    }
+
+    matrix_bin_header *header = NULL;
+    if (fstat(fd, st) == 0 && (size_t)st->st_size >= sizeof(matrix_bin_header))
+        header = mmap(NULL, st->st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (!header || header == MAP_FAILED) {
+        snprintf(error, error_size, "cannot map shared memory %s", name);
+        return NULL;
+    }
+    *length = st->st_size;
+
+    if (memcmp(header->magic, MATRIX_BIN_MAGIC, sizeof(header->magic)) != 0 ||
+        header->rows <= 0 || header->cols <= 0 ||
+        *length < sizeof(*header) + (size_t)header->rows * header->cols * sizeof(double)) {
+        snprintf(error, error_size, "shared memory %s is not a binary matrix", name);
+        munmap(header, *length);
+        return NULL;
+    }
+    return header;
+}
+
+// Create a shared memory object sized for a binary rows x cols matrix. It is
+// only resized after checking that it is not one of the mapped operands.
+static matrix_bin_header *create_shm_matrix(const char *name, int rows, int cols, size_t *length,
+                                            const struct stat *st_a, const struct stat *st_b,
+                                            char *error, size_t error_size) {
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0600);
+    if (fd < 0) {
+        snprintf(error, error_size, "cannot create shared memory %s: %s", name, strerror(errno));
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (st.st_dev == st_a->st_dev && st.st_ino == st_a->st_ino) ||
+        (st.st_dev == st_b->st_dev && st.st_ino == st_b->st_ino)) {
+        close(fd);
+        snprintf(error, error_size, "result %s must not be one of the operands", name);
+        return NULL;
+    }
+
+    *length = sizeof(matrix_bin_header) + (size_t)rows * cols * sizeof(double);
+    matrix_bin_header *header = MAP_FAILED;
+    if (ftruncate(fd, *length) == 0)
+        header = mmap(NULL, *length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (header == MAP_FAILED) {
+        snprintf(error, error_size, "cannot map shared memory %s", name);
+        return NULL;
+    }
+    matrix_bin_header init = { MATRIX_BIN_MAGIC, rows, cols, 0 };
+    *header = init;
+    return header;
+}
+
+// MUL <matrix_a> <matrix_b> [output_file]
+static int run_file_job(char **args, int num_args, char *reply, size_t reply_size) {
+    if (num_args < 2 || num_args > 3) {
+        snprintf(reply, reply_size, "ERR usage: MUL <matrix_a> <matrix_b> [output_file]");
+        return -1;
+    }
+
+    // Relative paths would resolve against the server's directory, not the client's
+    for (int i = 0; i < num_args; i++) {
+        if (args[i][0] != '/') {
+            snprintf(reply, reply_size, "ERR path must be absolute: %s", args[i]);
+            return -1;
+        }
+    }
+
+    char error[512];
+    cache_entry_t *entry_a = cache_lookup(args[0], error, sizeof(error));
+    if (!entry_a) {
+        snprintf(reply, reply_size, "ERR %s", error);
+        return -1;
+    }
+    // Pin A while B is looked up so the lookup cannot evict it
+    unsigned long saved_use = entry_a->last_used;
+    entry_a->last_used = (unsigned long)-1;
+    cache_entry_t *entry_b = cache_lookup(args[1], error, sizeof(error));
+    entry_a->last_used = saved_use;
+    if (!entry_b) {
+        snprintf(reply, reply_size, "ERR %s", error);
+        return -1;
+    }
+
+    if (entry_a->cols != entry_b->rows) {
+        snprintf(reply, reply_size, "ERR dimensions incompatible: A %dx%d, B %dx%d",
+                 entry_a->rows, entry_a->cols, entry_b->rows, entry_b->cols);
+        return -1;
+    }
+    if (!entry_b->transposed)
+        entry_b->transposed = transpose(entry_b->flat, entry_b->rows, entry_b->cols);
+
+    double *flat_result = malloc((size_t)entry_a->rows * entry_b->cols * sizeof(double));
+    multiply_job_t job = { entry_a->flat, entry_b->transposed, flat_result,
+                           entry_a->rows, entry_b->cols, entry_a->cols, 0 };
+
+    double start_time = now_seconds();
+    pool_run(&job);
+    double compute_time = now_seconds() - start_time;
+
+    if (num_args == 3) {
+        // Present the flat result as a matrix_struct without copying it
+        matrix_struct result = { job.rows, job.cols, malloc(job.rows * sizeof(double *)) };
+        for (int i = 0; i < job.rows; i++) {
+            result.mat_data[i] = flat_result + (size_t)i * job.cols;
+        }
+        long long bytes = store_matrix(&result, args[2]);
+        free(result.mat_data);
+        if (bytes < 0) {
+            free(flat_result);
+            snprintf(reply, reply_size, "ERR cannot write %s", args[2]);
+            return -1;
+        }
+    }
+    free(flat_result);
+
+    snprintf(reply, reply_size, "OK %d %d %.6f", job.rows, job.cols, compute_time);
+    return 0;
+}
+
+// SHM <shm_a> <shm_b> <shm_result>
+static int run_shm_job(char **args, int num_args, char *reply, size_t reply_size) {
+    if (num_args != 3) {
+        snprintf(reply, reply_size, "ERR usage: SHM <shm_a> <shm_b> <shm_result>");
+        return -1;
+    }
+
+    char error[512];
+    size_t length_a, length_b, length_result;
+    struct stat st_a, st_b;
+    matrix_bin_header *header_a = map_shm_matrix(args[0], &length_a, &st_a, error, sizeof(error));
+    if (!header_a) {
+        snprintf(reply, reply_size, "ERR %s", error);
+        return -1;
+    }
+    matrix_bin_header *header_b = map_shm_matrix(args[1], &length_b, &st_b, error, sizeof(error));
+    if (!header_b) {
+        munmap(header_a, length_a);
+        snprintf(reply, reply_size, "ERR %s", error);
+        return -1;
+    }
+
+    int status = -1;
+    if (header_a->cols != header_b->rows) {
+        snprintf(reply, reply_size, "ERR dimensions incompatible: A %dx%d, B %dx%d",
+                 header_a->rows, header_a->cols, header_b->rows, header_b->cols);
+    } else {
+        matrix_bin_header *header_result = create_shm_matrix(args[2], header_a->rows, header_b->cols,
+                                                             &length_result, &st_a, &st_b,
+                                                             error, sizeof(error));
+        if (!header_result) {
+            snprintf(reply, reply_size, "ERR %s", error);
+        } else {
+            // A is used in place, only B is packed
+            double *transposed_b = transpose((double *)(header_b + 1), header_b->rows, header_b->cols);
+            multiply_job_t job = { (double *)(header_a + 1), transposed_b, (double *)(header_result + 1),
+                                   header_a->rows, header_b->cols, header_a->cols, 0 };
+
+            double start_time = now_seconds();
+            pool_run(&job);
+            double compute_time = now_seconds() - start_time;
+
+            free(transposed_b);
+            munmap(header_result, length_result);
+            snprintf(reply, reply_size, "OK %d %d %.6f", job.rows, job.cols, compute_time);
+            status = 0;
+        }
+    }
+
+    munmap(header_a, length_a);
+    munmap(header_b, length_b);
+    return status;
+}
+
+static void format_stats(char *reply, size_t reply_size) {
+    pthread_mutex_lock(&queue_lock);
+    unsigned long total = requests_done + requests_failed;
+    snprintf(reply, reply_size,
+             "OK queue_depth=%d max_queue_depth=%d requests=%lu failed=%lu "
+             "cache_hits=%lu cache_misses=%lu avg_wait=%.6f avg_latency=%.6f max_latency=%.6f",
+             queue_depth, max_queue_depth, requests_done, requests_failed,
+             cache_hits, cache_misses,
+             total ? total_wait_time / total : 0.0,
+             total ? total_latency / total : 0.0, max_latency);
+    pthread_mutex_unlock(&queue_lock);
+}
+
+static void send_reply(int fd, const char *reply) {
+    dprintf(fd, "%s\n", reply);
+    close(fd);
+}
+
+// Dispatcher thread: runs queued jobs one after another on the whole pool
+static void *dispatcher(void *arg) {
+    (void)arg;
+    char reply[1024];
+
+    for (;;) {
+        pthread_mutex_lock(&queue_lock);
+        while (!queue_head)
+            pthread_cond_wait(&queue_ready, &queue_lock);
+        request_t *request = queue_head;
+        queue_head = request->next;
+        if (!queue_head)
+            queue_tail = NULL;
+        queue_depth--;
+        pthread_mutex_unlock(&queue_lock);
+
+        // A request without connection tells the dispatcher to stop
+        if (request->fd < 0) {
+            free(request);
+            break;
+        }
+
+        double wait_time = now_seconds() - request->enqueue_time;
+
+        char *args[4];
+        int num_args = 0;
+        char *save;
+        char *command = strtok_r(request->line, REQUEST_SEPARATORS, &save);
+        char *token;
+        while (num_args < 4 && (token = strtok_r(NULL, REQUEST_SEPARATORS, &save)))
+            args[num_args++] = token;
+
+        int status;
+        if (is_command(command, "MUL")) {
+            status = run_file_job(args, num_args, reply, sizeof(reply));
+        } else if (is_command(command, "SHM")) {
+            status = run_shm_job(args, num_args, reply, sizeof(reply));
+        } else {
+            snprintf(reply, sizeof(reply), "ERR unknown command %s", command);
+            status = -1;
+        }
+        send_reply(request->fd, reply);
+
+        double latency = now_seconds() - request->enqueue_time;
+        pthread_mutex_lock(&queue_lock);
+        if (status == 0)
+            requests_done++;
+        else
+            requests_failed++;
+        total_wait_time += wait_time;
+        total_latency += latency;
+        if (latency > max_latency)
+            max_latency = latency;
+        pthread_mutex_unlock(&queue_lock);
+
+        free(request);
+    }
+
+    return NULL;
+}
+
+static void enqueue_request(request_t *request) {
+    request->next = NULL;
+    request->enqueue_time = now_seconds();
+
+    pthread_mutex_lock(&queue_lock);
+    if (queue_tail)
+        queue_tail->next = request;
+    else
+        queue_head = request;
+    queue_tail = request;
+    if (++queue_depth > max_queue_depth)
+        max_queue_depth = queue_depth;
+    pthread_cond_signal(&queue_ready);
+    pthread_mutex_unlock(&queue_lock);
+}
+
+// Read one newline terminated request line, returns 0 on success.
+// Gives up when the client stays silent for REQUEST_TIMEOUT_MS.
+static int read_request_line(int fd, char *line, size_t size) {
+    size_t length = 0;
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    while (length < size - 1) {
+        if (poll(&pfd, 1, REQUEST_TIMEOUT_MS) <= 0)
+            return -1;
+        ssize_t n = read(fd, line + length, size - 1 - length);
+        if (n <= 0)
+            return -1;
+
+        char *newline = memchr(line + length, '\n', n);
+        length += n;
+        if (newline) {
+            length = newline - line;
+            break;
+        }
+    }
+    line[length] = '\0';
+    return length > 0 ? 0 : -1;
+}
+
+static void connection_finished(void) {
+    pthread_mutex_lock(&queue_lock);
+    if (--active_connections == 0)
+        pthread_cond_broadcast(&connections_done);
+    pthread_mutex_unlock(&queue_lock);
+}
+
+// Connection thread: reads the request so a slow client only stalls itself.
+// Metrics and shutdown are answered right away, jobs go through the queue.
+static void *connection_handler(void *arg) {
+    int fd = (int)(intptr_t)arg;
+    request_t *request = malloc(sizeof(request_t));
+
+    if (read_request_line(fd, request->line, sizeof(request->line)) != 0) {
+        free(request);
+        close(fd);
+        connection_finished();
+        return NULL;
+    }
+
+    char reply[1024];
+    if (is_command(request->line, "STATS")) {
+        format_stats(reply, sizeof(reply));
+        send_reply(fd, reply);
+        free(request);
+    } else if (is_command(request->line, "SHUTDOWN")) {
+        send_reply(fd, "OK shutting down");
+        free(request);
+        stop_requested = 1;
+    } else if (!is_command(request->line, "MUL") && !is_command(request->line, "SHM")) {
+        send_reply(fd, "ERR unknown command, expected MUL, SHM, STATS or SHUTDOWN");
+        free(request);
+    } else if (stop_requested) {
+        send_reply(fd, "ERR shutting down");
+        free(request);
+    } else {
+        request->fd = fd;
+        enqueue_request(request);
+    }
+
+    connection_finished();
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = DEFAULT_SOCKET_PATH;
+    int num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    cache_capacity = DEFAULT_CACHE_ENTRIES;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:t:c:")) != -1) {
+        switch (opt) {
+        case 's':
+            socket_path = optarg;
+            break;
+        case 't':
+            num_threads = atoi(optarg);
+            break;
+        case 'c':
+            cache_capacity = atoi(optarg);
+            break;
+        default:
+            printf("Usage: %s [-s socket_path] [-t threads] [-c cache_entries]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (num_threads < 1 || cache_capacity < 2) {
+        printf("Error: need at least 1 thread and 2 cache entries\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        printf("Error: Socket path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(addr.sun_path, socket_path);
+    unlink(socket_path);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(listen_fd, SOMAXCONN) != 0) {
+        perror("Error creating socket");
+        exit(EXIT_FAILURE);
+    }
+
+    // Stop on SIGINT/SIGTERM so the socket gets removed. Installed before any
+    // thread exists; the other threads are created with both signals blocked.
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    cache = calloc(cache_capacity, sizeof(cache_entry_t));
+    pool_start(num_threads);
+    pthread_t dispatcher_thread;
+    create_thread(&dispatcher_thread, NULL, dispatcher, NULL);
+
+    printf("Matrix server listening on %s\n", socket_path);
+    printf("Using %d threads, caching up to %d operands\n", num_threads, cache_capacity);
+    fflush(stdout);
+
+    // Wake up regularly so a SHUTDOWN read by a connection thread is noticed
+    pthread_attr_t detached;
+    pthread_attr_init(&detached);
+    pthread_attr_setdetachstate(&detached, PTHREAD_CREATE_DETACHED);
+    while (!stop_requested) {
+        struct pollfd pfd = { listen_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, ACCEPT_POLL_MS) <= 0)
+            continue;
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0)
+            continue;
+
+        pthread_mutex_lock(&queue_lock);
+        active_connections++;
+        pthread_mutex_unlock(&queue_lock);
+
+        pthread_t thread;
+        if (create_thread(&thread, &detached, connection_handler, (void *)(intptr_t)fd) != 0) {
+            close(fd);
+            connection_finished();
+        }
+    }
+    pthread_attr_destroy(&detached);
+
+    // Wait for the connection threads, they either queued their job or
+    // answered ERR shutting down
+    pthread_mutex_lock(&queue_lock);
+    while (active_connections > 0)
+        pthread_cond_wait(&connections_done, &queue_lock);
+    pthread_mutex_unlock(&queue_lock);
+
+    // Let queued jobs finish, then stop the dispatcher and the pool
+    request_t *stop = malloc(sizeof(request_t));
+    stop->fd = -1;
+    enqueue_request(stop);
+    pthread_join(dispatcher_thread, NULL);
+    pool_stop();
+
+    close(listen_fd);
+    unlink(socket_path);
+    for (int i = 0; i < cache_capacity; i++) {
+        free_cache_entry(&cache[i]);
+    }
+    free(cache);
+
+    return 0;
+}
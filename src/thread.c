@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <time.h>
+#include <unistd.h>
 #include "matrix.h"
 
 #define DEFAULT_NUM_THREADS 4
@@ -47,15 +48,23 @@ void *matrix_multiply_thread(void *arg) {
 }
 
 int main(int argc, char **argv) {
-    if (argc != 3) {
-        printf("Usage: %s <matrix_a> <matrix_b>\n", argv[0]);
+    // Parse the optional output file
+    const char *output_file = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        if (opt == 'o')
+            output_file = optarg;
+    }
+
+    if (argc - optind != 2) {
+        printf("Usage: %s [-o output_file] <matrix_a> <matrix_b>\n", argv[0]);
         printf("Uses %d threads by default\n", DEFAULT_NUM_THREADS);
         exit(EXIT_FAILURE);
     }
 
     // Read matrices
-    matrix_struct *matrix_a = get_matrix_struct(argv[1]);
-    matrix_struct *matrix_b = get_matrix_struct(argv[2]);
+    matrix_struct *matrix_a = get_matrix_struct(argv[optind]);
+    matrix_struct *matrix_b = get_matrix_struct(argv[optind + 1]);
 
     // Validate dimensions
     if (matrix_a->cols != matrix_b->rows) {
@@ -125,6 +134,11 @@ int main(int argc, char **argv) {
         }
     }
 
+    // Write the full result if requested
+    if (output_file) {
+        save_matrix(result, output_file);
+    }
+
     // Cleanup
     free(threads);
     free(thread_data);
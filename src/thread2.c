@@ -22,15 +22,23 @@ int main(int argc, char **argv)
 {
     int num_procs = sysconf(_SC_NPROCESSORS_ONLN);
 
-    if (argc != 3) {
-        printf("Usage: %s <matrix_a> <matrix_b>\n", argv[0]);
+    // Parse the optional output file
+    const char *output_file = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        if (opt == 'o')
+            output_file = optarg;
+    }
+
+    if (argc - optind != 2) {
+        printf("Usage: %s [-o output_file] <matrix_a> <matrix_b>\n", argv[0]);
         printf("Automatically using %d threads (number of CPU cores)\n", num_procs);
         exit(EXIT_FAILURE);
     }
 
     // Read matrices
-    matrix_struct *matrix_a = get_matrix_struct(argv[1]);
-    matrix_struct *matrix_b = get_matrix_struct(argv[2]);
+    matrix_struct *matrix_a = get_matrix_struct(argv[optind]);
+    matrix_struct *matrix_b = get_matrix_struct(argv[optind + 1]);
 
     if (matrix_a->cols != matrix_b->rows) {
         printf("Error: Matrix dimensions incompatible for multiplication\n");
@@ -107,6 +115,11 @@ int main(int argc, char **argv)
         }
     }
 
+    // Write the full result if requested
+    if (output_file) {
+        save_matrix(result, output_file);
+    }
+
     // Cleanup
     free(threads);
     free(thread_data);